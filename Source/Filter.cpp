@@ -35,52 +35,76 @@ void Filter::reset() {
     std::fill(xn_2.begin(), xn_2.end(), 0.f);
     std::fill(yn_1.begin(), yn_1.end(), 0.f);
     std::fill(yn_2.begin(), yn_2.end(), 0.f);
+    ladder.reset();
 }
 
 
 void Filter::updateCoefficents() {
-    omega = (2 * mPI) * (mFc / mFs);
-    alpha = sin(omega) / (2 * mQ);
+    if (mFilterType == LADDER) {
+        ladder.setParameters(mFc, mQ, mFs);
+        return;
+    }
+
+    auto coefficients = calculateCoefficients(mFilterType, mFc, mFs, mQ);
+    a0 = coefficients.a0;
+    a1 = coefficients.a1;
+    a2 = coefficients.a2;
+    b0 = coefficients.b0;
+    b1 = coefficients.b1;
+    b2 = coefficients.b2;
+}
+
+Filter::Coefficients Filter::calculateCoefficients(FilterType type, float cutoff, double sampleRate, float q) {
+    const float mPI = juce::MathConstants<float>::pi;
+    float omega = (2 * mPI) * (cutoff / sampleRate);
+    float alpha = sin(omega) / (2 * q);
+    Coefficients c;
     
-    switch (mFilterType) {
+    switch (type) {
         case LPF:
-            a0 = 1 + alpha;
-            a1 = -2 * cos(omega);
-            a2 = 1 - alpha;
-            b0 = (1 - cos(omega)) / 2;
-            b1 = 1 - cos(omega);
-            b2 = (1 - cos(omega)) / 2;
+            c.a0 = 1 + alpha;
+            c.a1 = -2 * cos(omega);
+            c.a2 = 1 - alpha;
+            c.b0 = (1 - cos(omega)) / 2;
+            c.b1 = 1 - cos(omega);
+            c.b2 = (1 - cos(omega)) / 2;
             break;
         case HPF:
-            a0 = 1 + alpha;
-            a1 = -2 * cos(omega);
-            a2 = 1 - alpha;
-            b0 = (1 + cos(omega)) / 2;
-            b1 = -(1 + cos(omega));
-            b2 = (1 + cos(omega)) / 2;
+            c.a0 = 1 + alpha;
+            c.a1 = -2 * cos(omega);
+            c.a2 = 1 - alpha;
+            c.b0 = (1 + cos(omega)) / 2;
+            c.b1 = -(1 + cos(omega));
+            c.b2 = (1 + cos(omega)) / 2;
             break;
         case BPF:
-            a0 = 1 + alpha;
-            a1 = -2 * cos(omega);
-            a2 = 1 - alpha;
-            b0 = alpha;
-            b1 = 0.f;
-            b2 = -alpha;
+            c.a0 = 1 + alpha;
+            c.a1 = -2 * cos(omega);
+            c.a2 = 1 - alpha;
+            c.b0 = alpha;
+            c.b1 = 0.f;
+            c.b2 = -alpha;
             break;
         case APF:
-            a0 = 1 + alpha;
-            a1 = -2 * cos(omega);
-            a2 = 1 - alpha;
-            b0 = 1 - alpha;
-            b1 = -2 * cos(omega);
-            b2 = 1 + alpha;
+            c.a0 = 1 + alpha;
+            c.a1 = -2 * cos(omega);
+            c.a2 = 1 - alpha;
+            c.b0 = 1 - alpha;
+            c.b1 = -2 * cos(omega);
+            c.b2 = 1 + alpha;
             break;
+        // The ladder is not a biquad and has no coefficients to give
+        case LADDER:
         default:
             break;
     }
+    return c;
 }
 
 float Filter::processSample(int channel, float inputSample) {
+    if (mFilterType == LADDER)
+        return ladder.processSample(channel, inputSample);
+
     float x0 = inputSample;
     float y0 = (b0/a0)*x0 + (b1/a0)*xn_1[channel] + (b2/a0)*xn_2[channel] - (a1/a0)*yn_1[channel] - (a2/a0)*yn_2[channel];
     auto outputSample = y0;
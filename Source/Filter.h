@@ -10,12 +10,27 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "Ladder.h"
 
 
 
 class Filter {
 
 public:
+    enum FilterType {
+        LPF,
+        HPF,
+        BPF,
+        APF,
+        LADDER
+    };
+
+    struct Coefficients {
+        float a0 = 1.f, a1 = 0.f, a2 = 0.f, b0 = 1.f, b1 = 0.f, b2 = 0.f;
+    };
+
+    static Coefficients calculateCoefficients (FilterType type, float cutoff, double sampleRate, float q);
+
     void setCutoff (float cutoff);
     void setQ (float q);
     void setType (float type);
@@ -27,11 +42,9 @@ public:
 private:
     void updateCoefficents();
 
-    const float mPI = juce::MathConstants<float>::pi;
     float mFc = 20000.f;
     double mFs = 44100;
     float mQ = 0.7;
-    float alpha = 0.f, omega = 0.f;
     float a0 = 1.f, a1 = 0.f, a2 = 0.f, b0 = 0.f, b1 = 0.f, b2 = 0.f;
     
     std::array<float, 2> xn_1;
@@ -39,13 +52,8 @@ private:
     
     std::array<float, 2> yn_1;
     std::array<float, 2> yn_2;
-    
-    enum FilterType {
-        LPF,
-        HPF,
-        BPF,
-        APF
-    };
+
+    Ladder ladder;
 
     FilterType mFilterType = LPF;
 };
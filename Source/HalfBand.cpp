@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    HalfBand.cpp
+    Created: 21 Oct 2026 9:36:14am
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#include "HalfBand.h"
+
+// Even coefficients belong to the first phase, odd ones to the second
+const std::array<float, HalfBand::numCoefficients> HalfBand::coefficients {
+    0.037358376f, 0.13933870f, 0.28130537f, 0.43620995f,
+    0.58440755f, 0.71701909f, 0.83455011f, 0.94429212f
+};
+
+void HalfBand::reset(float value) {
+    // Every allpass passes a constant through unchanged
+    std::fill(xn_1.begin(), xn_1.end(), value);
+    std::fill(yn_1.begin(), yn_1.end(), value);
+}
+
+void HalfBand::upsample(float inputSample, float &first, float &second) {
+    first = inputSample;
+    second = inputSample;
+    for (int i = 0; i < numCoefficients; i += 2) {
+        first = allpass(i, first);
+        second = allpass(i + 1, second);
+    }
+}
+
+float HalfBand::downsample(float first, float second) {
+    // The later sample takes the first phase, so the two line up in time
+    auto even = second;
+    auto odd = first;
+    for (int i = 0; i < numCoefficients; i += 2) {
+        even = allpass(i, even);
+        odd = allpass(i + 1, odd);
+    }
+    return 0.5f * (even + odd);
+}
+
+float HalfBand::allpass(int index, float x) {
+    auto y = coefficients[index] * (x - yn_1[index]) + xn_1[index];
+    xn_1[index] = x;
+    yn_1[index] = y;
+    return y;
+}
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    HalfBand.h
+    Created: 21 Oct 2026 9:36:14am
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Polyphase half-band IIR for resampling by 2. The filter is two chains of
+// first-order allpasses running at the lower rate, one per output phase, so
+// it costs one multiply per coefficient per low-rate sample. An instance holds
+// the state for one channel in one direction.
+class HalfBand {
+
+public:
+    // Settles the filter as if it had been fed a constant value
+    void reset (float value = 0.f);
+
+    // One sample in, two samples out at twice the rate
+    void upsample (float inputSample, float& first, float& second);
+
+    // Two samples in, one sample out at half the rate
+    float downsample (float first, float second);
+
+private:
+    // Elliptic design with the passband to 0.2268 of the high rate, i.e.
+    // 20 kHz at 44.1 kHz, and over 100 dB of stopband attenuation
+    static constexpr int numCoefficients = 8;
+    static const std::array<float, numCoefficients> coefficients;
+
+    float allpass(int index, float x);
+
+    std::array<float, numCoefficients> xn_1 {};
+    std::array<float, numCoefficients> yn_1 {};
+};
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    Ladder.cpp
+    Created: 19 Oct 2026 4:47:18pm
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#include "Ladder.h"
+
+void Ladder::setParameters(float cutoff, float q, double sampleRate) {
+    auto fc = juce::jlimit(20.0, sampleRate * 0.49, static_cast<double>(cutoff));
+
+    // Switch up at fs/5 and back down a little lower, so a cutoff sitting
+    // near the threshold doesn't keep crossfading
+    if (fc > sampleRate * 0.2)
+        mIsOversampled = true;
+    else if (fc < sampleRate * 0.18)
+        mIsOversampled = false;
+
+    base.setParameters(fc, q, sampleRate);
+    oversampled.setParameters(fc, q, 2 * sampleRate);
+
+    // 5 ms crossfade between the two
+    mMixIncrement = static_cast<float>(1.0 / (0.005 * sampleRate));
+}
+
+void Ladder::reset() {
+    base.reset();
+    oversampled.reset();
+    for (int channel = 0; channel < 2; ++channel) {
+        upsamplers[channel].reset();
+        downsamplers[channel].reset();
+        mix[channel] = mIsOversampled ? 1.f : 0.f;
+    }
+}
+
+float Ladder::processSample(int channel, float inputSample) {
+    auto target = mIsOversampled ? 1.f : 0.f;
+    auto& amount = mix[channel];
+
+    if (amount != target) {
+        // A core that has been idle picks up where the running one is. The
+        // half-bands start settled on the current input and output, since a
+        // step through them would ring the resonance.
+        if (amount == 0.f) {
+            oversampled.copyState(base, channel);
+            upsamplers[channel].reset(inputSample);
+            downsamplers[channel].reset(base.s[channel][numStages - 1]);
+        }
+        else if (amount == 1.f) {
+            base.copyState(oversampled, channel);
+        }
+        amount = target > amount ? juce::jmin(target, amount + mMixIncrement)
+                                 : juce::jmax(target, amount - mMixIncrement);
+    }
+
+    float y = 0.f;
+    if (amount < 1.f)
+        y += (1 - amount) * base.processSample(channel, inputSample);
+
+    if (amount > 0.f) {
+        float first, second;
+        upsamplers[channel].upsample(inputSample, first, second);
+        first = oversampled.processSample(channel, first);
+        second = oversampled.processSample(channel, second);
+        y += amount * downsamplers[channel].downsample(first, second);
+    }
+
+    return y;
+}
+
+void Ladder::Core::setParameters(double fc, float q, double sampleRate) {
+    const double pi = juce::MathConstants<double>::pi;
+
+    // For small signals ADAA averages each stage input with the previous one,
+    // which adds half a sample of lag per stage. Pick g so the loop still
+    // resonates at fc, i.e. each stage lags 45 degrees there. That only has a
+    // solution below fs/4, so past the cap the uncompensated curve is scaled
+    // on. Only the 1x core goes there, while crossfading to 2x.
+    auto fTuned = juce::jmin(fc, sampleRate * 0.245);
+    auto w = pi * fTuned / sampleRate;
+    auto g = std::tan(w) / std::tan(pi / 4 - w);
+    if (fc > fTuned)
+        g *= std::tan(pi * fc / sampleRate) / std::tan(w);
+    G = static_cast<float>(g / (1 + g));
+
+    // Loop gain where each stage lags 45 degrees. With t = tan(pi * f / fs)
+    // that frequency solves t^2 + (g + 1)t - g = 0, and the inverse of the
+    // loop gain there is the feedback that self-oscillates.
+    auto t = 0.5 * (std::sqrt((g + 1) * (g + 1) + 4 * g) - (g + 1));
+    auto stagePower = 1 / ((1 + t * t) * (1 + t * t / (g * g)));
+    auto kLimit = 1 / (stagePower * stagePower);
+
+    // Q range of the biquads mapped to feedback just below self-oscillation
+    k = juce::jmap(juce::jlimit(0.1f, 3.f, q), 0.1f, 3.f, 0.f, static_cast<float>(0.95 * kLimit));
+}
+
+void Ladder::Core::reset() {
+    for (int channel = 0; channel < 2; ++channel) {
+        std::fill(s[channel].begin(), s[channel].end(), 0.f);
+        std::fill(xn_1[channel].begin(), xn_1[channel].end(), 0.f);
+        std::fill(slope[channel].begin(), slope[channel].end(), 1.f);
+    }
+}
+
+// Quintic soft clip with unity slope at 0. It reaches +-1 at the knee with
+// zero slope and curvature, so the clipped region joins smoothly.
+float Ladder::softClip(float x) {
+    if (x <= -knee)
+        return -1.f;
+    if (x >= knee)
+        return 1.f;
+
+    auto x2 = x * x;
+    return x * (1 - alpha * x2 + beta * x2 * x2);
+}
+
+double Ladder::softClipAntiderivative(double x) {
+    auto absX = std::abs(x);
+    auto x2 = juce::jmin(absX, static_cast<double>(knee));
+    x2 *= x2;
+
+    // Past the knee the curve continues linearly from its value there
+    return x2 * (0.5 - alpha / 4 * x2 + beta / 6 * x2 * x2) + juce::jmax(0.0, absX - knee);
+}
+
+void Ladder::Core::copyState(const Core &other, int channel) {
+    s[channel] = other.s[channel];
+    xn_1[channel] = other.xn_1[channel];
+    slope[channel] = other.slope[channel];
+}
+
+float Ladder::Core::saturate(float x, float &xn_1, float &slope) {
+    auto x0 = xn_1;
+    xn_1 = x;
+
+    if (std::abs(x) < knee && std::abs(x0) < knee) {
+        // Below the knee the antiderivative only has even powers, and
+        // (x^2n - x0^2n) / (x - x0) factors exactly into (x + x0) times a
+        // polynomial in x^2 and x0^2. Nothing cancels and nothing divides, so
+        // it holds in float right down to x == x0.
+        auto a = x * x;
+        auto b = x0 * x0;
+        auto sum2 = a + b;
+        auto sum4 = sum2 * sum2 - a * b;
+
+        // Ratio of the output to (x + x0) / 2, the linear ADAA response
+        slope = 1 - 0.5f * alpha * sum2 + beta / 3 * sum4;
+        return 0.5f * (x + x0) * slope;
+    }
+
+    // Past the knee F is linear, so only a crossing of it needs the general
+    // difference quotient. Take it in double since the two values are close.
+    float y;
+    if (x >= knee && x0 >= knee)
+        y = 1.f;
+    else if (x <= -knee && x0 <= -knee)
+        y = -1.f;
+    else {
+        double diff = x - x0;
+        y = std::abs(diff) < 1.0e-5 ? softClip(0.5f * (x + x0))
+                                    : static_cast<float>((softClipAntiderivative(x) - softClipAntiderivative(x0)) / diff);
+    }
+
+    auto mid = 0.5f * (x + x0);
+    slope = std::abs(mid) > 1.0e-6f ? juce::jlimit(0.f, 1.f, y / mid) : 1.f;
+    return y;
+}
+
+float Ladder::Core::processSample(int channel, float inputSample) {
+    auto& state = s[channel];
+    auto& inputs = xn_1[channel];
+    auto& slopes = slope[channel];
+
+    // Each stage is y = a * x + b when its saturator is linearised as
+    // slope * (x + xn_1) / 2, which is how first-order ADAA responds to small
+    // signals. Chain them to y4 = A * u + B and solve u = in - k * y4 directly.
+    float A = 1.f, B = 0.f;
+    for (int stage = 0; stage < numStages; ++stage) {
+        auto a = 0.5f * G * slopes[stage];
+        auto b = G * (0.5f * slopes[stage] * inputs[stage] - state[stage]) + state[stage];
+        A = a * A;
+        B = a * B + b;
+    }
+    auto x = (inputSample - k * B) / (1 + k * A);
+
+    // Trapezoidal one-pole per stage, driven by the saturated stage input
+    for (int stage = 0; stage < numStages; ++stage) {
+        auto sat = saturate(x, inputs[stage], slopes[stage]);
+
+        auto v = G * (sat - state[stage]);
+        auto y = v + state[stage];
+        state[stage] = y + v;
+        x = y;
+    }
+
+    return x;
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    Ladder.h
+    Created: 19 Oct 2026 4:47:18pm
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "HalfBand.h"
+
+// 4-pole lowpass ladder with a saturating input on every stage. Aliasing from
+// the saturation is reduced with first-order antiderivative anti-aliasing
+// (ADAA) instead of oversampling. The feedback loop is solved without a unit
+// delay, and the half-sample lag ADAA adds to each stage is taken into account
+// when tuning the cutoff and limiting the resonance. That compensation runs
+// out just below a quarter of the sample rate, so cutoffs above fs/5 run the
+// ladder at twice the rate, crossfading when it switches.
+class Ladder {
+
+public:
+    void setParameters (float cutoff, float q, double sampleRate);
+
+    void reset ();
+    float processSample (int channel, float inputSample);
+
+    static float softClip (float x);
+    static double softClipAntiderivative (double x);
+
+private:
+    static constexpr int numStages = 4;
+
+    // Soft clip x - alpha x^3 + beta x^5, flat at +-1 from the knee on
+    static constexpr float knee = 15.f / 8.f;
+    static constexpr float alpha = 2.f / (3.f * knee * knee);
+    static constexpr float beta = 1.f / (5.f * knee * knee * knee * knee);
+
+    // The ladder itself, running at one sample rate
+    struct Core {
+        void setParameters (double cutoff, float q, double sampleRate);
+        void reset ();
+        void copyState (const Core& other, int channel);
+        float processSample (int channel, float inputSample);
+
+        static float saturate (float x, float& xn_1, float& slope);
+
+        float G = 0.f;
+        float k = 0.f;
+
+        // One-pole integrator states
+        std::array<std::array<float, numStages>, 2> s;
+
+        // Previous stage input for ADAA
+        std::array<std::array<float, numStages>, 2> xn_1;
+
+        // Last ratio of saturator output to its linear response, used to predict
+        // the stages when solving the feedback loop
+        std::array<std::array<float, numStages>, 2> slope;
+    };
+
+    Core base;
+    Core oversampled;
+    std::array<HalfBand, 2> upsamplers;
+    std::array<HalfBand, 2> downsamplers;
+
+    // Share of the oversampled core in the output, per channel
+    bool mIsOversampled = false;
+    float mMixIncrement = 1.f;
+    std::array<float, 2> mix {};
+};
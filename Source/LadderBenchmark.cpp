@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+
+    LadderBenchmark.cpp
+    Created: 20 Oct 2026 11:05:52am
+    Author:  Elja Markkanen
+
+    Standalone measurement of the ADAA ladder against a 4x-oversampled ladder
+    without ADAA. Not part of the plugin build; compile it on its own against
+    the Projucer-generated JuceLibraryCode, for example:
+
+        c++ -std=c++17 -O2 -IJuceLibraryCode -I<JUCE>/modules \
+            Source/LadderBenchmark.cpp Source/Ladder.cpp Source/HalfBand.cpp \
+            Source/Filter.cpp -o LadderBenchmark
+
+    Reports feedback stability and resonance tuning over the whole cutoff
+    range, aliasing energy for a stepped sine sweep and CPU time per sample,
+    with the plugin's linear lowpass biquad as the CPU baseline.
+
+  ==============================================================================
+*/
+
+#include "Filter.h"
+#include "HalfBand.h"
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr double pi = juce::MathConstants<double>::pi;
+
+// Same zero-delay ladder with an instantaneous saturator and no ADAA, so the
+// usual prewarped cutoff and the textbook k = 4 limit apply
+class ReferenceLadder {
+
+public:
+    void setParameters (float cutoff, float q, double sampleRate) {
+        auto fc = juce::jlimit(20.0, sampleRate * 0.49, static_cast<double>(cutoff));
+        auto g = std::tan(pi * fc / sampleRate);
+        G = static_cast<float>(g / (1 + g));
+        k = juce::jmap(juce::jlimit(0.1f, 3.f, q), 0.1f, 3.f, 0.f, 0.95f * 4.f);
+    }
+
+    float processSample (float inputSample) {
+        float A = 1.f, B = 0.f;
+        for (int stage = 0; stage < 4; ++stage) {
+            auto a = G * slope[stage];
+            auto b = (1 - G) * s[stage];
+            A = a * A;
+            B = a * B + b;
+        }
+        auto x = (inputSample - k * B) / (1 + k * A);
+
+        for (int stage = 0; stage < 4; ++stage) {
+            auto sat = Ladder::softClip(x);
+            slope[stage] = std::abs(x) > 1.0e-6f ? sat / x : 1.f;
+
+            auto v = G * (sat - s[stage]);
+            auto y = v + s[stage];
+            s[stage] = y + v;
+            x = y;
+        }
+        return x;
+    }
+
+private:
+    float G = 0.f;
+    float k = 0.f;
+    std::array<float, 4> s {};
+    std::array<float, 4> slope { 1.f, 1.f, 1.f, 1.f };
+};
+
+// 4x resampling as two cascaded 2x half-band IIR stages each way, the way
+// juce::dsp::Oversampling does it in its polyphase IIR mode
+class Resampler {
+
+public:
+    static constexpr int factor = 4;
+
+    // One input sample in, factor samples out
+    void upsample (float inputSample, std::array<float, factor>& output) {
+        float first, second;
+        upsamplers[0].upsample(inputSample, first, second);
+        upsamplers[1].upsample(first, output[0], output[1]);
+        upsamplers[1].upsample(second, output[2], output[3]);
+    }
+
+    // factor samples in, one sample out
+    float downsample (const std::array<float, factor>& input) {
+        auto first = downsamplers[1].downsample(input[0], input[1]);
+        auto second = downsamplers[1].downsample(input[2], input[3]);
+        return downsamplers[0].downsample(first, second);
+    }
+
+private:
+    std::array<HalfBand, 2> upsamplers;
+    std::array<HalfBand, 2> downsamplers;
+};
+
+void fft (std::vector<std::complex<double>>& data) {
+    auto n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        auto bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+    for (size_t length = 2; length <= n; length <<= 1) {
+        auto w = std::polar(1.0, -2 * pi / length);
+        for (size_t i = 0; i < n; i += length) {
+            std::complex<double> wn(1.0);
+            for (size_t j = 0; j < length / 2; ++j) {
+                auto u = data[i + j];
+                auto v = data[i + j + length / 2] * wn;
+                data[i + j] = u + v;
+                data[i + j + length / 2] = u - v;
+                wn *= w;
+            }
+        }
+    }
+}
+
+enum Engine {
+    ADAA,
+    PLAIN_1X,
+    PLAIN_4X,
+    LINEAR_LPF
+};
+
+// The ADAA engine is the plugin's ladder, which runs at 2x above fs/5
+const char* engineNames[] = { "ADAA", "plain 1x", "plain 4x", "linear LP" };
+
+// Runs one engine over the input at the base rate
+std::vector<float> render (Engine engine, const std::vector<float>& input, float cutoff, float q, double sampleRate) {
+    std::vector<float> output(input.size());
+
+    if (engine == ADAA) {
+        Ladder ladder;
+        ladder.setParameters(cutoff, q, sampleRate);
+        ladder.reset();
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = ladder.processSample(0, input[i]);
+    }
+    else if (engine == PLAIN_1X) {
+        ReferenceLadder ladder;
+        ladder.setParameters(cutoff, q, sampleRate);
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = ladder.processSample(input[i]);
+    }
+    else if (engine == LINEAR_LPF) {
+        Filter filter;
+        filter.reset();
+        filter.setSampleRate(sampleRate);
+        filter.setType(Filter::LPF);
+        filter.setQ(q);
+        filter.setCutoff(cutoff);
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = filter.processSample(0, input[i]);
+    }
+    else {
+        ReferenceLadder ladder;
+        Resampler resampler;
+        ladder.setParameters(cutoff, q, sampleRate * Resampler::factor);
+        std::array<float, Resampler::factor> block;
+        for (size_t i = 0; i < input.size(); ++i) {
+            resampler.upsample(input[i], block);
+            for (auto& sample : block)
+                sample = ladder.processSample(sample);
+            output[i] = resampler.downsample(block);
+        }
+    }
+    return output;
+}
+
+void measureStability() {
+    std::printf("Stability: 0.1 impulse, peak over the last 100 ms of 2 s, worst Q\n");
+    std::printf("%10s", "fc \\ fs");
+    const double sampleRates[] = { 44100, 48000, 96000 };
+    for (auto fs : sampleRates)
+        std::printf("%12.0f", fs);
+    std::printf("\n");
+
+    const float cutoffs[] = { 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 15000, 20000 };
+    for (auto fc : cutoffs) {
+        std::printf("%10.0f", fc);
+        for (auto fs : sampleRates) {
+            auto length = static_cast<int>(2 * fs);
+            float worst = 0.f;
+
+            // Worst case over the Q range, not just the top of it
+            for (float q = 0.1f; q <= 3.001f; q += 0.29f) {
+                Ladder ladder;
+                ladder.setParameters(fc, q, fs);
+                ladder.reset();
+                float peak = 0.f;
+                for (int i = 0; i < length; ++i) {
+                    auto y = ladder.processSample(0, i == 0 ? 0.1f : 0.f);
+                    if (i >= length - fs / 10)
+                        peak = std::max(peak, std::abs(y));
+                }
+                worst = std::max(worst, peak);
+            }
+            std::printf("%12.2e", worst);
+        }
+        std::printf("\n");
+    }
+    std::printf("\n");
+}
+
+void measureTuning() {
+    const double fs = 48000;
+    const int size = 1 << 16;
+
+    std::printf("Resonance tuning at %.0f Hz, Q = 3: impulse response peak\n", fs);
+    std::printf("%10s %12s %12s\n", "fc", engineNames[ADAA], engineNames[PLAIN_1X]);
+
+    const float cutoffs[] = { 100, 500, 1000, 2000, 5000, 9000, 12000, 16000, 20000 };
+    for (auto fc : cutoffs) {
+        std::printf("%10.0f", fc);
+        for (auto engine : { ADAA, PLAIN_1X }) {
+            std::vector<float> input(size, 0.f);
+            input[0] = 0.01f;
+            auto output = render(engine, input, fc, 3.f, fs);
+
+            std::vector<std::complex<double>> spectrum(output.begin(), output.end());
+            fft(spectrum);
+            size_t peak = 1;
+            for (size_t bin = 1; bin < size / 2; ++bin) {
+                if (std::abs(spectrum[bin]) > std::abs(spectrum[peak]))
+                    peak = bin;
+            }
+            std::printf("%12.0f", peak * fs / size);
+        }
+        std::printf("\n");
+    }
+    std::printf("\n");
+}
+
+void measureAliasing(float drive) {
+    const double fs = 48000;
+    const int size = 1 << 16;
+    const float cutoff = 5000.f, q = 1.f;
+
+    std::printf("Aliasing at %.0f Hz, cutoff %.0f Hz, Q %.1f, sine amplitude %.1f\n", fs, cutoff, q, drive);
+    std::printf("Energy outside the harmonics, relative to the harmonics (dB)\n");
+    std::printf("%10s %12s %12s %12s\n", "tone", engineNames[0], engineNames[1], engineNames[2]);
+
+    // Odd bins keep every folded harmonic off the true harmonic bins
+    const float tones[] = { 500, 1000, 2000, 3000, 5000, 7000, 10000, 14000 };
+    for (auto tone : tones) {
+        auto bin = static_cast<int>(tone * size / fs) | 1;
+        std::printf("%10.0f", bin * fs / size);
+
+        std::vector<float> input(2 * size);
+        for (size_t i = 0; i < input.size(); ++i)
+            input[i] = drive * static_cast<float>(std::sin(2 * pi * bin * static_cast<double>(i) / size));
+
+        for (auto engine : { ADAA, PLAIN_1X, PLAIN_4X }) {
+            auto output = render(engine, input, cutoff, q, fs);
+
+            // Second half only, once the filter has settled
+            std::vector<std::complex<double>> spectrum(output.begin() + size, output.end());
+            fft(spectrum);
+
+            double harmonics = 0, rest = 0;
+            for (int b = 1; b < size / 2; ++b) {
+                auto power = std::norm(spectrum[b]);
+                if (b % bin == 0)
+                    harmonics += power;
+                else
+                    rest += power;
+            }
+            std::printf("%12.1f", 10 * std::log10(rest / harmonics + 1.0e-30));
+        }
+        std::printf("\n");
+    }
+    std::printf("\n");
+}
+
+void measureCpu() {
+    const double fs = 48000;
+    std::vector<float> input(static_cast<size_t>(10 * fs));
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = 2.f * static_cast<float>(std::sin(2 * pi * 220 * static_cast<double>(i) / fs));
+
+    std::printf("CPU time for 10 s at %.0f Hz, one channel, ns per sample\n", fs);
+    std::printf("%10s %12s %12s\n", "engine", "fc 2000", "fc 15000");
+
+    for (auto engine : { LINEAR_LPF, ADAA, PLAIN_1X, PLAIN_4X }) {
+        std::printf("%10s", engineNames[engine]);
+        for (auto cutoff : { 2000.f, 15000.f }) {
+            auto start = std::chrono::steady_clock::now();
+            auto output = render(engine, input, cutoff, 2.f, fs);
+            auto end = std::chrono::steady_clock::now();
+
+            volatile float sink = output.back();
+            juce::ignoreUnused(sink);
+
+            std::printf("%12.1f", std::chrono::duration<double, std::nano>(end - start).count() / input.size());
+        }
+        std::printf("\n");
+    }
+    std::printf("(plain 4x includes two half-band IIR stages each way)\n");
+}
+
+}
+
+int main() {
+    measureStability();
+    measureTuning();
+    measureAliasing(1.f);
+    measureAliasing(4.f);
+    measureCpu();
+    return 0;
+}
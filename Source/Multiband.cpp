@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    Multiband.cpp
+    Created: 19 Oct 2026 10:12:40am
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#include "Multiband.h"
+
+void Multiband::prepare(const juce::dsp::ProcessSpec &spec) {
+    mFs = spec.sampleRate;
+
+    // 5 ms fade around layout changes
+    mFadeIncrement = static_cast<float>(1.0 / (0.005 * mFs));
+
+    for (auto& crossover : mCrossovers) {
+        crossover.reset(mFs, 0.05);
+    }
+    for (int band = 0; band < maxBands; ++band) {
+        mBandCutoffs[band].reset(mFs, 0.05);
+        mBandQs[band].reset(mFs, 0.05);
+    }
+
+    applyLayout();
+    mLayoutGain = 1.f;
+}
+
+void Multiband::reset() {
+    for (int channel = 0; channel < 2; ++channel) {
+        std::fill(s1[channel].begin(), s1[channel].end(), SIMDFloat::expand(0.f));
+        std::fill(s2[channel].begin(), s2[channel].end(), SIMDFloat::expand(0.f));
+    }
+}
+
+void Multiband::setNumBands(int numBands) {
+    this->mTargetNumBands = juce::jlimit(1, maxBands, numBands);
+}
+
+void Multiband::setCrossover(int index, float frequency) {
+    mCrossovers[index].setTargetValue(frequency);
+}
+
+void Multiband::setBand(int band, float type, float cutoff, float q) {
+    this->mTargetBandTypes[band] = static_cast<Filter::FilterType>(static_cast<int>(type));
+    mBandCutoffs[band].setTargetValue(cutoff);
+    mBandQs[band].setTargetValue(q);
+}
+
+void Multiband::process(juce::AudioBuffer<float> &buffer, int numChannels) {
+    numChannels = juce::jmin(numChannels, 2);
+    auto numSamples = buffer.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += controlInterval) {
+        auto blockSize = juce::jmin(controlInterval, numSamples - start);
+
+        // Switch layouts only while the output is silent
+        if (isLayoutPending() && mLayoutGain == 0.f)
+            applyLayout();
+
+        auto isGliding = updateParameters(blockSize);
+        if (isGliding) {
+            for (int stage = 0; stage < NUM_STAGES; ++stage) {
+                auto scale = SIMDFloat::expand(1.f / blockSize);
+                steps[stage].b0 = (targets[stage].b0 - stages[stage].b0) * scale;
+                steps[stage].b1 = (targets[stage].b1 - stages[stage].b1) * scale;
+                steps[stage].b2 = (targets[stage].b2 - stages[stage].b2) * scale;
+                steps[stage].a1 = (targets[stage].a1 - stages[stage].a1) * scale;
+                steps[stage].a2 = (targets[stage].a2 - stages[stage].a2) * scale;
+            }
+        }
+
+        auto startGain = mLayoutGain;
+        auto targetGain = isLayoutPending() ? 0.f : 1.f;
+        auto fade = mFadeIncrement * blockSize;
+        mLayoutGain = startGain < targetGain ? juce::jmin(targetGain, startGain + fade)
+                                             : juce::jmax(targetGain, startGain - fade);
+        auto gainStep = (mLayoutGain - startGain) / blockSize;
+
+        std::array<float*, 2> data {};
+        for (int channel = 0; channel < numChannels; ++channel) {
+            data[channel] = buffer.getWritePointer(channel, start);
+        }
+
+        auto gain = startGain;
+        for (int sample = 0; sample < blockSize; ++sample) {
+            gain += gainStep;
+            for (int channel = 0; channel < numChannels; ++channel) {
+                data[channel][sample] = gain * processSample(channel, data[channel][sample]);
+            }
+            if (isGliding)
+                advanceCoefficients();
+        }
+
+        // Land exactly on the targets rather than on accumulated steps
+        if (isGliding)
+            stages = targets;
+    }
+}
+
+void Multiband::advanceCoefficients() {
+    for (int stage = 0; stage < NUM_STAGES; ++stage) {
+        stages[stage].b0 += steps[stage].b0;
+        stages[stage].b1 += steps[stage].b1;
+        stages[stage].b2 += steps[stage].b2;
+        stages[stage].a1 += steps[stage].a1;
+        stages[stage].a2 += steps[stage].a2;
+    }
+}
+
+bool Multiband::updateParameters(int numSamples) {
+    bool crossoversChanged = false;
+    for (auto& crossover : mCrossovers) {
+        if (crossover.isSmoothing()) {
+            crossover.skip(numSamples);
+            crossoversChanged = true;
+        }
+    }
+    if (crossoversChanged)
+        updateCrossovers();
+
+    bool bandsChanged = false;
+    for (int band = 0; band < maxBands; ++band) {
+        if (mBandCutoffs[band].isSmoothing() || mBandQs[band].isSmoothing()) {
+            mBandCutoffs[band].skip(numSamples);
+            mBandQs[band].skip(numSamples);
+            updateBand(band);
+            bandsChanged = true;
+        }
+    }
+    return crossoversChanged || bandsChanged;
+}
+
+bool Multiband::isLayoutPending() const {
+    return mTargetNumBands != mNumBands || mTargetBandTypes != mBandTypes;
+}
+
+void Multiband::applyLayout() {
+    this->mNumBands = mTargetNumBands;
+    this->mBandTypes = mTargetBandTypes;
+
+    updateCrossovers();
+    for (int lane = 0; lane < numLanes; ++lane) {
+        updateBand(lane);
+    }
+    stages = targets;
+    reset();
+}
+
+void Multiband::updateCrossovers() {
+    std::array<float, maxBands - 1> crossovers;
+    for (int i = 0; i < maxBands - 1; ++i) {
+        crossovers[i] = mCrossovers[i].getCurrentValue();
+    }
+    std::sort(crossovers.begin(), crossovers.begin() + (mNumBands - 1));
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        for (int stage = 0; stage < BAND; ++stage) {
+            setSection(stage, lane, THRU, 0.f);
+        }
+    }
+
+    // Each band takes one path through the split tree. Bands that skip a split
+    // get an allpass at that crossover instead, so the sum stays flat.
+    switch (mNumBands) {
+        case 2:
+            setSplit(SPLIT_1, 0, LOW, crossovers[0]);
+            setSplit(SPLIT_1, 1, HIGH, crossovers[0]);
+            break;
+        case 3:
+            setSplit(SPLIT_1, 0, LOW, crossovers[0]);
+            setSection(COMPENSATION, 0, ALL, crossovers[1]);
+            setSplit(SPLIT_1, 1, HIGH, crossovers[0]);
+            setSplit(SPLIT_2, 1, LOW, crossovers[1]);
+            setSplit(SPLIT_1, 2, HIGH, crossovers[0]);
+            setSplit(SPLIT_2, 2, HIGH, crossovers[1]);
+            break;
+        case 4:
+            setSplit(SPLIT_1, 0, LOW, crossovers[1]);
+            setSplit(SPLIT_2, 0, LOW, crossovers[0]);
+            setSection(COMPENSATION, 0, ALL, crossovers[2]);
+            setSplit(SPLIT_1, 1, LOW, crossovers[1]);
+            setSplit(SPLIT_2, 1, HIGH, crossovers[0]);
+            setSection(COMPENSATION, 1, ALL, crossovers[2]);
+            setSplit(SPLIT_1, 2, HIGH, crossovers[1]);
+            setSplit(SPLIT_2, 2, LOW, crossovers[2]);
+            setSection(COMPENSATION, 2, ALL, crossovers[0]);
+            setSplit(SPLIT_1, 3, HIGH, crossovers[1]);
+            setSplit(SPLIT_2, 3, HIGH, crossovers[2]);
+            setSection(COMPENSATION, 3, ALL, crossovers[0]);
+            break;
+        default:
+            break;
+    }
+}
+
+void Multiband::updateBand(int band) {
+    if (band >= mNumBands) {
+        Filter::Coefficients mute;
+        mute.b0 = 0.f;
+        setLane(BAND, band, mute);
+        return;
+    }
+
+    auto cutoff = juce::jlimit(20.f, static_cast<float>(mFs * 0.49), mBandCutoffs[band].getCurrentValue());
+    setLane(BAND, band, Filter::calculateCoefficients(mBandTypes[band], cutoff, mFs, mBandQs[band].getCurrentValue()));
+}
+
+void Multiband::setSplit(int stage, int lane, Section section, float frequency) {
+    // LR4 is two Butterworth sections in series
+    setSection(stage, lane, section, frequency);
+    setSection(stage + 1, lane, section, frequency);
+}
+
+void Multiband::setSection(int stage, int lane, Section section, float frequency) {
+    const float butterworthQ = juce::MathConstants<float>::sqrt2 / 2;
+    auto fc = juce::jlimit(20.f, static_cast<float>(mFs * 0.49), frequency);
+
+    switch (section) {
+        case THRU:
+            setLane(stage, lane, Filter::Coefficients());
+            break;
+        case LOW:
+            setLane(stage, lane, Filter::calculateCoefficients(Filter::LPF, fc, mFs, butterworthQ));
+            break;
+        case HIGH:
+            setLane(stage, lane, Filter::calculateCoefficients(Filter::HPF, fc, mFs, butterworthQ));
+            break;
+        case ALL:
+            setLane(stage, lane, Filter::calculateCoefficients(Filter::APF, fc, mFs, butterworthQ));
+            break;
+        default:
+            break;
+    }
+}
+
+void Multiband::setLane(int stage, int lane, const Filter::Coefficients &coefficients) {
+    auto& s = targets[stage];
+    s.b0.set(lane, coefficients.b0 / coefficients.a0);
+    s.b1.set(lane, coefficients.b1 / coefficients.a0);
+    s.b2.set(lane, coefficients.b2 / coefficients.a0);
+    s.a1.set(lane, coefficients.a1 / coefficients.a0);
+    s.a2.set(lane, coefficients.a2 / coefficients.a0);
+}
+
+float Multiband::processSample(int channel, float inputSample) {
+    auto x = SIMDFloat::expand(inputSample);
+    auto& z1 = s1[channel];
+    auto& z2 = s2[channel];
+
+    // Transposed direct form II, all bands at once
+    for (int stage = 0; stage < NUM_STAGES; ++stage) {
+        const auto& s = stages[stage];
+        auto y = s.b0 * x + z1[stage];
+        z1[stage] = s.b1 * x - s.a1 * y + z2[stage];
+        z2[stage] = s.b2 * x - s.a2 * y;
+        x = y;
+    }
+
+    return x.sum();
+}
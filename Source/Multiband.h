@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    Multiband.h
+    Created: 19 Oct 2026 10:12:40am
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Filter.h"
+
+// Splits the signal into up to four Linkwitz-Riley bands, filters each band
+// and sums them back together. Every band runs the same chain of biquads with
+// its own coefficients, so the bands sit in the lanes of one SIMD register and
+// are processed in a single pass. Cutoffs, Qs and crossovers are smoothed, and
+// changes to the band layout or a band's type fade the output out and back in.
+class Multiband {
+
+public:
+    static constexpr int maxBands = 4;
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset ();
+
+    void setNumBands (int numBands);
+    void setCrossover (int index, float frequency);
+    void setBand (int band, float type, float cutoff, float q);
+
+    void process (juce::AudioBuffer<float>& buffer, int numChannels);
+
+private:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = static_cast<int>(SIMDFloat::SIMDNumElements);
+    static_assert(numLanes >= maxBands, "SIMD register must hold every band");
+
+    // Smoothed values are applied to the coefficients once per this many samples
+    static constexpr int controlInterval = 32;
+
+    // Coefficients normalised by a0, one set per lane
+    struct Stage {
+        SIMDFloat b0, b1, b2, a1, a2;
+    };
+
+    // Sections a crossover slot can hold
+    enum Section {
+        THRU,
+        LOW,
+        HIGH,
+        ALL
+    };
+
+    // Two LR4 splits, one allpass for phase compensation and the band filter
+    enum Slot {
+        SPLIT_1 = 0,
+        SPLIT_2 = 2,
+        COMPENSATION = 4,
+        BAND = 5,
+        NUM_STAGES
+    };
+
+    float processSample(int channel, float inputSample);
+    bool updateParameters(int numSamples);
+    void advanceCoefficients();
+    bool isLayoutPending() const;
+    void applyLayout();
+
+    void updateCrossovers();
+    void updateBand(int band);
+    void setSection(int stage, int lane, Section section, float frequency);
+    void setSplit(int stage, int lane, Section section, float frequency);
+    void setLane(int stage, int lane, const Filter::Coefficients& coefficients);
+
+    double mFs = 44100;
+    int mNumBands = maxBands;
+    std::array<Filter::FilterType, maxBands> mBandTypes { Filter::LPF, Filter::LPF, Filter::LPF, Filter::LPF };
+
+    // Layout requested by the host, applied once the output has faded out
+    int mTargetNumBands = maxBands;
+    std::array<Filter::FilterType, maxBands> mTargetBandTypes { Filter::LPF, Filter::LPF, Filter::LPF, Filter::LPF };
+    float mLayoutGain = 1.f;
+    float mFadeIncrement = 1.f;
+
+    std::array<juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>, maxBands - 1> mCrossovers;
+    std::array<juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>, maxBands> mBandCutoffs;
+    std::array<juce::SmoothedValue<float>, maxBands> mBandQs;
+
+    // Coefficients in use, the ones they glide to over the current control
+    // block and the per-sample step between them
+    std::array<Stage, NUM_STAGES> stages;
+    std::array<Stage, NUM_STAGES> targets;
+    std::array<Stage, NUM_STAGES> steps;
+
+    std::array<std::array<SIMDFloat, NUM_STAGES>, 2> s1;
+    std::array<std::array<SIMDFloat, NUM_STAGES>, 2> s2;
+};
@@ -25,13 +25,22 @@ ICMPfilterAudioProcessor::ICMPfilterAudioProcessor()
     treeState.addParameterListener("cutoff", this);
     treeState.addParameterListener("quality", this);
     treeState.addParameterListener("fType", this);
+    treeState.addParameterListener("polyType", this);
     treeState.addParameterListener("lfoOn", this);
     treeState.addParameterListener("lfoWave", this);
     treeState.addParameterListener("lfoDepth", this);
     treeState.addParameterListener("lfoRate", this);
 
-
-
+    mbBands = treeState.getRawParameterValue("mbBands");
+    for (int i = 0; i < Multiband::maxBands - 1; ++i) {
+        xovers[i] = treeState.getRawParameterValue("xover" + juce::String(i + 1));
+    }
+    for (int band = 0; band < Multiband::maxBands; ++band) {
+        auto prefix = "band" + juce::String(band + 1);
+        bandTypes[band] = treeState.getRawParameterValue(prefix + "Type");
+        bandCutoffs[band] = treeState.getRawParameterValue(prefix + "Cutoff");
+        bandQs[band] = treeState.getRawParameterValue(prefix + "Q");
+    }
 }
 
 ICMPfilterAudioProcessor::~ICMPfilterAudioProcessor()
@@ -39,6 +48,7 @@ ICMPfilterAudioProcessor::~ICMPfilterAudioProcessor()
     treeState.removeParameterListener("cutoff", this);
     treeState.removeParameterListener("quality", this);
     treeState.removeParameterListener("fType", this);
+    treeState.removeParameterListener("polyType", this);
     treeState.removeParameterListener("lfoOn", this);
     treeState.removeParameterListener("lfoWave", this);
     treeState.removeParameterListener("lfoDepth", this);
@@ -118,6 +128,9 @@ void ICMPfilterAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     smoothQ.reset(5);
     
     filter.setSampleRate(sampleRate);
+    updateMultiband();
+    multiband.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), static_cast<juce::uint32>(getTotalNumOutputChannels()) });
+    polyFilter.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), static_cast<juce::uint32>(getTotalNumOutputChannels()) });
 
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate / 2;
@@ -166,6 +179,7 @@ void ICMPfilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     auto cutoffVal = treeState.getRawParameterValue("cutoff")->load();
     auto qVal = treeState.getRawParameterValue("quality")->load();
     bool isLfoOn = treeState.getRawParameterValue("lfoOn")->load();
+    auto mode = static_cast<Mode>(static_cast<int>(treeState.getRawParameterValue("mode")->load()));
     float lfoDepth = lfo.getLfoDepth();
     auto lfoDepthMapped = juce::jmap(lfoDepth, 0.f, 10.f, 0.f, 10000.f);
     
@@ -180,6 +194,29 @@ void ICMPfilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
+    // MIDI only reaches the voice pool in poly mode, so drop any voices that
+    // would otherwise miss their note-offs and stay stuck
+    if (mode != mCurrentMode) {
+        polyFilter.reset();
+        multiband.reset();
+        mCurrentMode = mode;
+    }
+
+    if (mode == POLY) {
+        polyFilter.setCutoff(smoothedCutoff);
+        polyFilter.setQ(smoothedQ);
+        polyFilter.setLfoOn(isLfoOn);
+        polyFilter.setLfoDepth(lfoDepthMapped);
+        polyFilter.process(buffer, midiMessages);
+        return;
+    }
+
+    if (mode == MULTIBAND) {
+        updateMultiband();
+        multiband.process(buffer, getTotalNumInputChannels());
+        return;
+    }
+
     for (int channel = 0; channel < getTotalNumInputChannels(); ++channel) {
         auto* in = buffer.getReadPointer (channel);
         auto* out = buffer.getWritePointer (channel);
@@ -256,6 +293,19 @@ void ICMPfilterAudioProcessor::updateParameters() {
     
 }
 
+void ICMPfilterAudioProcessor::updateMultiband() {
+    auto numBands = static_cast<int>(mbBands->load()) + 2;
+    multiband.setNumBands(numBands);
+    
+    for (int i = 0; i < Multiband::maxBands - 1; ++i) {
+        multiband.setCrossover(i, xovers[i]->load());
+    }
+    
+    for (int band = 0; band < Multiband::maxBands; ++band) {
+        multiband.setBand(band, bandTypes[band]->load(), bandCutoffs[band]->load(), bandQs[band]->load());
+    }
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout ICMPfilterAudioProcessor::createParamLayout()
 {
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
@@ -264,12 +314,28 @@ juce::AudioProcessorValueTreeState::ParameterLayout ICMPfilterAudioProcessor::cr
     
     layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"cutoff", 1}, "Cutoff", range{20, 20000, 1, 0.3}, 20000));
     layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"quality", 1}, "Q", range{0.1f, 3.f, 0.1f}, 0.1f));
-    layout.add(std::make_unique<juce::AudioParameterChoice>(pID{"fType", 1}, "Type", juce::StringArray{"LP","HP","BP","AP"}, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(pID{"fType", 1}, "Type", juce::StringArray{"LP","HP","BP","AP","Ladder"}, 0));
     layout.add(std::make_unique<juce::AudioParameterBool>(pID{"lfoOn", 1}, "LFO On", false));
     layout.add(std::make_unique<juce::AudioParameterChoice>(pID{"lfoWave", 1}, "LFO Waveform", juce::StringArray{"Sine","Ramp Up", "Ramp Down", "Square"}, 0));
     layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"lfoDepth", 1}, "LFO Depth", range{0.f, 10.f, 0.1f}, 0.f));
     layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"lfoRate", 1}, "LFO Rate", range{0.1f, 250.f, 0.1}, 1.f));
     
+    layout.add(std::make_unique<juce::AudioParameterChoice>(pID{"mode", 1}, "Mode", juce::StringArray{"Single","Multiband","Poly MIDI"}, 0));
+    // The voices are SIMD biquads, so poly mode has its own type without the ladder
+    layout.add(std::make_unique<juce::AudioParameterChoice>(pID{"polyType", 1}, "Poly Type", juce::StringArray{"LP","HP","BP","AP"}, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(pID{"mbBands", 1}, "Bands", juce::StringArray{"2","3","4"}, 2));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"xover1", 1}, "Crossover 1", range{20, 20000, 1, 0.3}, 200));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"xover2", 1}, "Crossover 2", range{20, 20000, 1, 0.3}, 1000));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(pID{"xover3", 1}, "Crossover 3", range{20, 20000, 1, 0.3}, 5000));
+    
+    for (int band = 1; band <= Multiband::maxBands; ++band) {
+        auto id = "band" + juce::String(band);
+        auto name = "Band " + juce::String(band);
+        layout.add(std::make_unique<juce::AudioParameterChoice>(pID{id + "Type", 1}, name + " Type", juce::StringArray{"LP","HP","BP","AP"}, 0));
+        layout.add(std::make_unique<juce::AudioParameterFloat>(pID{id + "Cutoff", 1}, name + " Cutoff", range{20, 20000, 1, 0.3}, 20000));
+        layout.add(std::make_unique<juce::AudioParameterFloat>(pID{id + "Q", 1}, name + " Q", range{0.1f, 3.f, 0.1f}, 0.7f));
+    }
+    
     return layout;
 }
 
@@ -280,12 +346,16 @@ void ICMPfilterAudioProcessor::parameterChanged(const juce::String &parameterID,
         filter.reset();
         filter.setType(newValue);
     }
+    if (parameterID == "polyType") {
+        polyFilter.setType(newValue);
+    }
     if (parameterID == "lfoOn") {
         filter.reset();
     }
     if (parameterID == "lfoWave") {
         filter.reset();
         lfo.selectWaveform(newValue);
+        polyFilter.selectLfoWaveform(newValue);
     }
     if (parameterID == "lfoDepth") {
         lfo.setLfoDepth(newValue);
@@ -293,6 +363,7 @@ void ICMPfilterAudioProcessor::parameterChanged(const juce::String &parameterID,
     
     if (parameterID == "lfoRate") {
         lfo.setFrequency(newValue);
+        polyFilter.setLfoFrequency(newValue);
     }
 }
 
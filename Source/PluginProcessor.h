@@ -11,6 +11,8 @@
 #include <JuceHeader.h>
 #include "Filter.h"
 #include "Lfo.h"
+#include "Multiband.h"
+#include "PolyFilter.h"
 
 
 //==============================================================================
@@ -68,11 +70,28 @@ public:
 
 private:
     void updateParameters();
+    void updateMultiband();
+
+    enum Mode {
+        SINGLE,
+        MULTIBAND,
+        POLY
+    };
+
+    Mode mCurrentMode = SINGLE;
 
     LFO lfo;
     int samplesSinceLastUpdate = 100;
 
     Filter filter;
+    Multiband multiband;
+    std::atomic<float>* mbBands = nullptr;
+    std::array<std::atomic<float>*, Multiband::maxBands - 1> xovers {};
+    std::array<std::atomic<float>*, Multiband::maxBands> bandTypes {};
+    std::array<std::atomic<float>*, Multiband::maxBands> bandCutoffs {};
+    std::array<std::atomic<float>*, Multiband::maxBands> bandQs {};
+
+    PolyFilter polyFilter;
 
     juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> smoothCutoff;
     juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> smoothModCutoff;
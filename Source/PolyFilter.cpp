@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    PolyFilter.cpp
+    Created: 19 Oct 2026 2:31:05pm
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#include "PolyFilter.h"
+
+void PolyFilter::prepare(const juce::dsp::ProcessSpec &spec) {
+    mFs = spec.sampleRate;
+
+    // 5 ms fade in and out so voices start and stop without clicks. Both rates
+    // are per sample, since the last control block of a buffer is shorter.
+    mLevelIncrement = static_cast<float>(1.0 / (0.005 * mFs));
+
+    // Smooths the 1/sqrt(voices) gain over about 10 ms
+    mVoiceGainTime = static_cast<float>(0.01 * mFs);
+
+    reset();
+}
+
+void PolyFilter::reset() {
+    std::fill(voices.begin(), voices.end(), Voice());
+    mVoiceGain = 1.f;
+
+    for (auto& group : groups) {
+        for (int lane = 0; lane < numLanes; ++lane) {
+            muteLane(group, lane);
+        }
+        std::fill(group.s1.begin(), group.s1.end(), SIMDFloat::expand(0.f));
+        std::fill(group.s2.begin(), group.s2.end(), SIMDFloat::expand(0.f));
+        group.isActive = false;
+    }
+}
+
+void PolyFilter::setType(float type) {
+    // Voices are biquads, so the ladder is not available here
+    this->mFilterType = static_cast<Filter::FilterType>(juce::jlimit(0, static_cast<int>(Filter::APF), static_cast<int>(type)));
+}
+
+void PolyFilter::setCutoff(float cutoff) {
+    this->mFc = cutoff;
+}
+
+void PolyFilter::setQ(float q) {
+    this->mQ = q;
+}
+
+void PolyFilter::setLfoOn(bool isOn) {
+    this->mIsLfoOn = isOn;
+}
+
+void PolyFilter::selectLfoWaveform(float waveform) {
+    this->mWaveform = static_cast<Waveform>(static_cast<int>(waveform));
+}
+
+void PolyFilter::setLfoFrequency(float freq) {
+    this->mLfoFrequency = freq;
+}
+
+void PolyFilter::setLfoDepth(float depthHz) {
+    this->mLfoDepth = depthHz;
+}
+
+void PolyFilter::process(juce::AudioBuffer<float> &buffer, const juce::MidiBuffer &midiMessages) {
+    auto numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    auto numSamples = buffer.getNumSamples();
+    auto midiIterator = midiMessages.cbegin();
+
+    for (int start = 0; start < numSamples; start += controlInterval) {
+        auto blockSize = juce::jmin(controlInterval, numSamples - start);
+
+        // Events are applied at the start of the control block they fall in
+        for (; midiIterator != midiMessages.cend() && (*midiIterator).samplePosition < start + blockSize; ++midiIterator) {
+            const auto metadata = *midiIterator;
+
+            // Anything longer than a channel message would be copied to the heap
+            if (metadata.numBytes <= 3)
+                handleMidiMessage(metadata.getMessage());
+        }
+
+        updateVoices(blockSize);
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto* data = buffer.getWritePointer(channel, start);
+
+            std::array<SIMDFloat, numGroups> gains;
+            for (int g = 0; g < numGroups; ++g) {
+                gains[g] = groups[g].gain;
+            }
+
+            for (int sample = 0; sample < blockSize; ++sample) {
+                auto x = SIMDFloat::expand(data[sample]);
+                auto sum = SIMDFloat::expand(0.f);
+
+                for (int g = 0; g < numGroups; ++g) {
+                    auto& group = groups[g];
+                    if (!group.isActive)
+                        continue;
+
+                    auto y = group.b0 * x + group.s1[channel];
+                    group.s1[channel] = group.b1 * x - group.a1 * y + group.s2[channel];
+                    group.s2[channel] = group.b2 * x - group.a2 * y;
+
+                    gains[g] += group.gainStep;
+                    sum += y * gains[g];
+                }
+                data[sample] = sum.sum();
+            }
+        }
+    }
+}
+
+void PolyFilter::handleMidiMessage(const juce::MidiMessage &message) {
+    if (message.isNoteOn()) {
+        noteOn(message.getChannel(), message.getNoteNumber(), message.getFloatVelocity());
+    }
+    else if (message.isNoteOff()) {
+        noteOff(message.getChannel(), message.getNoteNumber());
+    }
+    else if (message.isChannelPressure()) {
+        setPressure(message.getChannel(), -1, message.getChannelPressureValue() / 127.f);
+    }
+    else if (message.isAftertouch()) {
+        setPressure(message.getChannel(), message.getNoteNumber(), message.getAfterTouchValue() / 127.f);
+    }
+    else if (message.isAllSoundOff()) {
+        reset();
+    }
+    else if (message.isAllNotesOff()) {
+        for (auto& voice : voices) {
+            voice.isHeld = false;
+            voice.isPending = false;
+        }
+    }
+}
+
+void PolyFilter::noteOn(int midiChannel, int note, float velocity) {
+    int index = -1;
+    for (int i = 0; i < maxVoices; ++i) {
+        if (!voices[i].isActive) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0)
+        index = findVoiceToSteal();
+
+    // A stolen voice that is still sounding fades out over the next control
+    // block, and the new note takes the lane after that
+    auto& voice = voices[index];
+    if (voice.isActive && voice.level > 0.f) {
+        voice.pendingNote = note;
+        voice.pendingChannel = midiChannel;
+        voice.pendingDepth = velocity;
+        voice.isPending = true;
+        voice.isHeld = false;
+        voice.age = ++mNoteCounter;
+        return;
+    }
+
+    startVoice(index, midiChannel, note, velocity);
+}
+
+void PolyFilter::startVoice(int index, int midiChannel, int note, float velocity) {
+    auto& voice = voices[index];
+    voice.note = note;
+    voice.midiChannel = midiChannel;
+    voice.depth = velocity;
+    voice.lfoPhase = 0.f;
+    voice.level = 0.f;
+    voice.age = ++mNoteCounter;
+    voice.isHeld = true;
+    voice.isActive = true;
+    voice.isPending = false;
+
+    auto& group = groups[index / numLanes];
+    auto lane = index % numLanes;
+    for (int channel = 0; channel < 2; ++channel) {
+        group.s1[channel].set(lane, 0.f);
+        group.s2[channel].set(lane, 0.f);
+    }
+}
+
+void PolyFilter::noteOff(int midiChannel, int note) {
+    for (auto& voice : voices) {
+        if (voice.isHeld && voice.note == note && voice.midiChannel == midiChannel)
+            voice.isHeld = false;
+        if (voice.isPending && voice.pendingNote == note && voice.pendingChannel == midiChannel)
+            voice.isPending = false;
+    }
+}
+
+void PolyFilter::setPressure(int midiChannel, int note, float pressure) {
+    for (auto& voice : voices) {
+        if (voice.isActive && voice.midiChannel == midiChannel && (note < 0 || voice.note == note))
+            voice.depth = pressure;
+    }
+}
+
+int PolyFilter::findVoiceToSteal() const {
+    // Oldest released voice first, then the oldest held one
+    int oldest = 0;
+    for (int i = 1; i < maxVoices; ++i) {
+        const auto& voice = voices[i];
+        const auto& current = voices[oldest];
+        if (voice.isHeld < current.isHeld || (voice.isHeld == current.isHeld && voice.age < current.age))
+            oldest = i;
+    }
+    return oldest;
+}
+
+void PolyFilter::updateVoices(int numSamples) {
+    const auto maxCutoff = juce::jmin(20000.f, static_cast<float>(mFs * 0.49));
+
+    // Voices all filter the same input, so scale the sum to keep chords from
+    // getting louder with every note
+    int numActive = 0;
+    for (const auto& voice : voices) {
+        if (voice.isActive)
+            numActive++;
+    }
+    auto startGain = mVoiceGain;
+    auto targetGain = 1.f / std::sqrt(static_cast<float>(juce::jmax(1, numActive)));
+    mVoiceGain += (1.f - std::exp(-numSamples / mVoiceGainTime)) * (targetGain - mVoiceGain);
+    auto levelIncrement = mLevelIncrement * numSamples;
+
+    for (int g = 0; g < numGroups; ++g) {
+        auto& group = groups[g];
+        group.isActive = false;
+
+        for (int lane = 0; lane < numLanes; ++lane) {
+            auto& voice = voices[g * numLanes + lane];
+            if (voice.isPending && voice.level == 0.f)
+                startVoice(g * numLanes + lane, voice.pendingChannel, voice.pendingNote, voice.pendingDepth);
+
+            if (!voice.isActive) {
+                muteLane(group, lane);
+                continue;
+            }
+            group.isActive = true;
+
+            auto target = voice.isHeld ? 1.f : 0.f;
+            auto level = voice.level < target ? juce::jmin(target, voice.level + levelIncrement)
+                                              : juce::jmax(target, voice.level - levelIncrement);
+            if (voice.isPending)
+                level = 0.f;
+            group.gain.set(lane, voice.level * startGain);
+            group.gainStep.set(lane, (level * mVoiceGain - voice.level * startGain) / numSamples);
+            voice.level = level;
+
+            // Fades out over this control block, then the lane goes idle
+            if (!voice.isHeld && !voice.isPending && level == 0.f)
+                voice.isActive = false;
+
+            auto cutoff = mFc * std::pow(2.f, (voice.note - 60) / 12.f);
+            if (mIsLfoOn) {
+                cutoff += getLfoValue(voice.lfoPhase) * mLfoDepth * voice.depth;
+                voice.lfoPhase += static_cast<float>(mLfoFrequency * numSamples / mFs);
+                voice.lfoPhase -= std::floor(voice.lfoPhase);
+            }
+            cutoff = juce::jlimit(20.f, maxCutoff, cutoff);
+
+            auto c = Filter::calculateCoefficients(mFilterType, cutoff, mFs, mQ);
+            group.b0.set(lane, c.b0 / c.a0);
+            group.b1.set(lane, c.b1 / c.a0);
+            group.b2.set(lane, c.b2 / c.a0);
+            group.a1.set(lane, c.a1 / c.a0);
+            group.a2.set(lane, c.a2 / c.a0);
+        }
+    }
+}
+
+void PolyFilter::muteLane(Group &group, int lane) {
+    group.b0.set(lane, 0.f);
+    group.b1.set(lane, 0.f);
+    group.b2.set(lane, 0.f);
+    group.a1.set(lane, 0.f);
+    group.a2.set(lane, 0.f);
+    group.gain.set(lane, 0.f);
+    group.gainStep.set(lane, 0.f);
+}
+
+float PolyFilter::getLfoValue(float phase) const {
+    switch (mWaveform) {
+        case SINE:
+            return std::sin(2 * juce::MathConstants<float>::pi * phase);
+        case RAMP_UP:
+            return 2 * phase - 1;
+        case RAMP_DOWN:
+            return 1 - 2 * phase;
+        case SQUARE:
+            return phase < 0.5f ? 1.f : -1.f;
+        default:
+            return 0.f;
+    }
+}
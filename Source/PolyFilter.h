@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    PolyFilter.h
+    Created: 19 Oct 2026 2:31:05pm
+    Author:  Elja Markkanen
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Filter.h"
+
+// Polyphonic filter driven by MIDI/MPE. Every held note takes a voice from a
+// fixed pool and filters the input with a key-tracked cutoff. Velocity or
+// pressure sets the voice's LFO depth, and every voice has its own LFO phase.
+// Voices are packed into SIMD groups; groups with no sounding voice are skipped.
+// The output is only the sum of the voices, so it is silent while no note is held.
+class PolyFilter {
+
+public:
+    static constexpr int maxVoices = 8;
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset ();
+
+    void setType (float type);
+    void setCutoff (float cutoff);
+    void setQ (float q);
+    void setLfoOn (bool isOn);
+    void selectLfoWaveform (float waveform);
+    void setLfoFrequency (float freq);
+    void setLfoDepth (float depthHz);
+
+    void process (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages);
+
+private:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = static_cast<int>(SIMDFloat::SIMDNumElements);
+    static constexpr int numGroups = maxVoices / numLanes;
+    static_assert(numGroups > 0 && maxVoices % numLanes == 0, "Voices must fill whole SIMD groups");
+
+    // Voice coefficients and LFOs are updated once per this many samples
+    static constexpr int controlInterval = 32;
+
+    struct Voice {
+        int note = -1;
+        int midiChannel = 0;
+        float depth = 0.f;
+        float lfoPhase = 0.f;
+        float level = 0.f;
+        juce::uint32 age = 0;
+        bool isHeld = false;
+        bool isActive = false;
+
+        // Note that stole this voice, started once the old one has faded out
+        int pendingNote = -1;
+        int pendingChannel = 0;
+        float pendingDepth = 0.f;
+        bool isPending = false;
+    };
+
+    // Coefficients normalised by a0, one voice per lane
+    struct Group {
+        SIMDFloat b0, b1, b2, a1, a2;
+        SIMDFloat gain, gainStep;
+        std::array<SIMDFloat, 2> s1;
+        std::array<SIMDFloat, 2> s2;
+        bool isActive = false;
+    };
+
+    enum Waveform {
+        SINE,
+        RAMP_UP,
+        RAMP_DOWN,
+        SQUARE
+    };
+
+    void handleMidiMessage(const juce::MidiMessage& message);
+    void noteOn(int midiChannel, int note, float velocity);
+    void startVoice(int index, int midiChannel, int note, float velocity);
+    void noteOff(int midiChannel, int note);
+    void setPressure(int midiChannel, int note, float pressure);
+    int findVoiceToSteal() const;
+
+    void updateVoices(int numSamples);
+    void muteLane(Group& group, int lane);
+    float getLfoValue(float phase) const;
+
+    double mFs = 44100;
+    float mFc = 1000.f;
+    float mQ = 0.7f;
+    float mLfoFrequency = 1.f;
+    float mLfoDepth = 0.f;
+    float mLevelIncrement = 1.f;
+    float mVoiceGain = 1.f;
+    float mVoiceGainTime = 1.f;
+    bool mIsLfoOn = false;
+    juce::uint32 mNoteCounter = 0;
+
+    Filter::FilterType mFilterType = Filter::LPF;
+    Waveform mWaveform = SINE;
+
+    std::array<Voice, maxVoices> voices;
+    std::array<Group, numGroups> groups;
+};